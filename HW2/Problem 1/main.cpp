@@ -1,6 +1,10 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <fstream>
+#include <string>
+#include "../../common/poly_prof.h"
+#include "../../common/poly_script.h"
 using namespace std;
 
 //==============================
@@ -31,6 +35,33 @@ public:
         capacity = cap;
         terms = 0;
         termArray = new Term[capacity];
+        POLY_PROF_COUNT(ArrayAlloc, 1);
+    }
+
+    // 複製建構函式
+    Polynomial(const Polynomial& poly) {
+        capacity = poly.capacity;
+        terms = poly.terms;
+        termArray = new Term[capacity];
+        POLY_PROF_COUNT(ArrayAlloc, 1);
+        copy(poly.termArray, poly.termArray + terms, termArray);
+    }
+
+    // 移動建構函式：直接接手 poly 的陣列
+    Polynomial(Polynomial&& poly) {
+        capacity = poly.capacity;
+        terms = poly.terms;
+        termArray = poly.termArray;
+        poly.capacity = poly.terms = 0;
+        poly.termArray = nullptr;
+    }
+
+    // 指派運算子（複製或移動後交換）
+    Polynomial& operator=(Polynomial poly) {
+        swap(termArray, poly.termArray);
+        swap(capacity, poly.capacity);
+        swap(terms, poly.terms);
+        return *this;
     }
 
     // 解構函式
@@ -38,17 +69,64 @@ public:
         delete[] termArray;
     }
 
+    //==============================
+    // NewTerm：在尾端加入一項，容量不足時加倍
+    //==============================
+    void NewTerm(float c, int e) {
+        if (terms == capacity) {
+            capacity = capacity ? capacity * 2 : 1;
+            Term* temp = new Term[capacity];
+            copy(termArray, termArray + terms, temp);
+            delete[] termArray;
+            termArray = temp;
+            POLY_PROF_COUNT(ArrayAlloc, 1);
+            POLY_PROF_COUNT(ArrayRealloc, 1);
+        }
+        termArray[terms].coef = c;
+        termArray[terms].exp = e;
+        terms++;
+    }
+
+    //==============================
+    // ReadTerms：不顯示提示，讀入 n c1 e1 ... cn en
+    // 項目可以任意順序，相同指數的項會合併
+    //==============================
+    bool ReadTerms(istream& in) {
+        int n;
+        if (!(in >> n) || n < 0) // 項數不可為負
+            return false;
+
+        terms = 0;
+        for (int i = 0; i < n; i++) {
+            float c;
+            int e;
+            if (!(in >> c >> e))
+                return false;
+            NewTerm(c, e);
+        }
+
+        Normalize();
+        return true;
+    }
+
     //==============================
     // 輸入運算子 >>
     //==============================
     friend istream& operator>>(istream& in, Polynomial& poly) {
         cout << "請輸入多項式的項數：";
         in >> poly.terms;
+        if (poly.terms < 0) { // 項數不可為負
+            poly.terms = 0;
+            in.setstate(ios::failbit);
+            return in;
+        }
 
         if (poly.terms > poly.capacity) {
             delete[] poly.termArray;
             poly.capacity = poly.terms;
             poly.termArray = new Term[poly.capacity];
+            POLY_PROF_COUNT(ArrayAlloc, 1);
+            POLY_PROF_COUNT(ArrayRealloc, 1);
         }
 
         cout << "請輸入每項 (係數 指數)，例如：3 2 表示 3x^2：" << endl;
@@ -57,10 +135,7 @@ public:
             in >> poly.termArray[i].coef >> poly.termArray[i].exp;
         }
 
-        // 按指數由大到小排序
-        sort(poly.termArray, poly.termArray + poly.terms,
-             [](const Term& a, const Term& b) { return a.exp > b.exp; });
-
+        poly.Normalize();
         return in;
     }
 
@@ -98,35 +173,22 @@ public:
     // 加法函式 Add
     //==============================
     Polynomial Add(const Polynomial& poly) const {
-        Polynomial result(capacity + poly.capacity);
-        int i = 0, j = 0, k = 0;
-
-        while (i < terms && j < poly.terms) {
-            if (termArray[i].exp == poly.termArray[j].exp) {
-                float sum = termArray[i].coef + poly.termArray[j].coef;
-                if (fabs(sum) > 1e-6) {
-                    result.termArray[k].coef = sum;
-                    result.termArray[k].exp = termArray[i].exp;
-                    k++;
-                }
-                i++; j++;
-            } else if (termArray[i].exp > poly.termArray[j].exp)
-                result.termArray[k++] = termArray[i++];
-            else
-                result.termArray[k++] = poly.termArray[j++];
-        }
-
-        while (i < terms) result.termArray[k++] = termArray[i++];
-        while (j < poly.terms) result.termArray[k++] = poly.termArray[j++];
+        POLY_PROF_SCOPE(OpAdd);
+        return Merge(poly, 1);
+    }
 
-        result.terms = k;
-        return result;
+    //==============================
+    // 減法函式 Sub
+    //==============================
+    Polynomial Sub(const Polynomial& poly) const {
+        return Merge(poly, -1);
     }
 
     //==============================
     // 乘法函式 Mult
     //==============================
     Polynomial Mult(const Polynomial& poly) const {
+        POLY_PROF_SCOPE(OpMult);
         Polynomial result(terms * poly.terms + 1);
 
         for (int i = 0; i < terms; i++) {
@@ -169,17 +231,101 @@ public:
     // Eval：代入 x 計算值
     //==============================
     float Eval(float x) const {
+        POLY_PROF_SCOPE(OpEval);
         float sum = 0;
         for (int i = 0; i < terms; i++)
             sum += termArray[i].coef * pow(x, termArray[i].exp);
         return sum;
     }
+
+private:
+    //==============================
+    // Normalize：按指數由大到小排序，合併指數相同的項並去除係數為 0 的項
+    // Add / Mult 都假設項目依指數遞減且指數不重複
+    //==============================
+    void Normalize() {
+        sort(termArray, termArray + terms,
+             [](const Term& a, const Term& b) { return a.exp > b.exp; });
+
+        int k = 0;
+        for (int i = 0; i < terms;) {
+            int e = termArray[i].exp;
+            float sum = 0;
+            for (; i < terms && termArray[i].exp == e; i++)
+                sum += termArray[i].coef;
+            if (fabs(sum) > 1e-6) {
+                termArray[k].coef = sum;
+                termArray[k].exp = e;
+                k++;
+            }
+        }
+        terms = k;
+    }
+
+    //==============================
+    // Merge：合併 *this 與 sign * poly（Add / Sub 共用）
+    //==============================
+    Polynomial Merge(const Polynomial& poly, int sign) const {
+        Polynomial result(capacity + poly.capacity);
+        int i = 0, j = 0, k = 0;
+
+        while (i < terms && j < poly.terms) {
+            if (termArray[i].exp == poly.termArray[j].exp) {
+                float sum = termArray[i].coef + sign * poly.termArray[j].coef;
+                if (fabs(sum) > 1e-6) {
+                    result.termArray[k].coef = sum;
+                    result.termArray[k].exp = termArray[i].exp;
+                    k++;
+                }
+                i++; j++;
+            } else if (termArray[i].exp > poly.termArray[j].exp)
+                result.termArray[k++] = termArray[i++];
+            else {
+                result.termArray[k].coef = sign * poly.termArray[j].coef;
+                result.termArray[k++].exp = poly.termArray[j++].exp;
+            }
+        }
+
+        while (i < terms) result.termArray[k++] = termArray[i++];
+        while (j < poly.terms) {
+            result.termArray[k].coef = sign * poly.termArray[j].coef;
+            result.termArray[k++].exp = poly.termArray[j++].exp;
+        }
+
+        result.terms = k;
+        return result;
+    }
 };
 
+//==============================
+// 批次指令模式（指令說明見 common/poly_script.h）
+//==============================
+int RunScript(istream& in) {
+    return RunPolyScript<Polynomial>(
+        in,
+        [](Polynomial& p, istream& is) { return p.ReadTerms(is); },
+        [](const Polynomial& a, const Polynomial& b) { return a.Add(b); },
+        [](const Polynomial& a, const Polynomial& b) { return a.Sub(b); },
+        [](const Polynomial& a, const Polynomial& b) { return a.Mult(b); },
+        [](const Polynomial& a, float x) { return a.Eval(x); });
+}
+
 //==============================
 // 主程式區
+// 執行時給定指令檔（或 - 代表標準輸入）即進入批次模式
 //==============================
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        if (string(argv[1]) == "-")
+            return RunScript(cin);
+        ifstream script(argv[1]);
+        if (!script) {
+            cerr << "無法開啟指令檔：" << argv[1] << endl;
+            return 1;
+        }
+        return RunScript(script);
+    }
+
     Polynomial p1, p2;
 
     cout << "=== 輸入第一個多項式 ===" << endl;
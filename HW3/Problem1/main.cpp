@@ -1,58 +1,446 @@
 #include <iostream>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <cmath>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <string>
+#include "../../common/poly_prof.h"
+#include "../../common/poly_script.h"
 using namespace std;
 
 /* =================================================
    可用空間串列（Available Space List）
    用來回收已刪除的節點，降低 new/delete 成本
+
+   每個執行緒各自擁有一份節點快取，Get/Return
+   只操作本執行緒的快取，不需任何同步；快取用完或超過
+   上限時，才以「一整批」節點為單位和全域池交換。
+   全域池是固定數量的原子槽位，每個槽位放一批節點，
+   以 exchange / compare_exchange 存取，不使用鎖；
+   只有在所有槽位都滿了的少見情況下，才把批次暫放到
+   有鎖保護的溢位區。
+
+   節點不再逐一 new，而是從大塊連續的 slab 中依位址
+   順序切出，新建立的串列在記憶體中也是連續的。
+   Trim() 會把完全空閒的 slab 還給系統。
+
+   NodePool 對節點型別的要求：有 Node* link 欄位，
+   以及一個 int 欄位 Length（空閒時用來記錄批次長度）。
+   Kind 為量測用的種類，每一種節點各自擁有一份池與統計。
    ================================================= */
 
+template <class Node, int Node::*Length, int Kind>
+class NodePool {
+public:
+    // 取得一個節點（優先從本執行緒的快取中取），內容未初始化
+    static Node* Get() {
+        ThreadCache& tc = cache;
+        if (!tc.avail)
+            Refill(tc);
+        Node* p = tc.avail;
+        tc.avail = p->link;
+        tc.count--;
+        POLY_PROF_POOL(Kind, Get, 1);
+#ifdef POLY_PROFILE
+        // 新切出的節點位於快取底部，快取數量低於它們時表示交出的是新節點
+        if (tc.count < tc.fresh) {
+            tc.fresh = tc.count;
+            POLY_PROF_POOL(Kind, Fresh, 1);
+        }
+#endif
+        return p;
+    }
+
+    // 回收節點至本執行緒的快取，超過上限時整批移往全域池
+    static void Return(Node* p) {
+        ThreadCache& tc = cache;
+        POLY_PROF_POOL(Kind, Return, 1);
+        p->link = tc.avail;
+        tc.avail = p;
+        if (++tc.count > CacheLimit)
+            Spill(tc);
+    }
+
+    // 回收整個循環串列（表頭節點加上 n - 1 個節點），不需走訪
+    // 讓表頭節點指向可用串列，整串即變成 head->link ... -> head -> 可用串列
+    static void ReturnList(Node* head, int n);
+
+    // 釋放完全空閒的 slab，並把其餘空閒節點依位址重新排好
+    // 回傳釋放的 slab 數量
+    static int Trim();
+
+    // 統計資料
+    // Get / Return 只更新本執行緒的快取數量，查詢時才先把本執行緒的數量計入，
+    // 因此對呼叫的執行緒是精確的；其他執行緒尚未計入的部分
+    // 每個執行緒最多為 CacheLimit 個節點
+    static long Slabs() { return slabCount.load(memory_order_relaxed); }
+    static long FreeNodes() {
+        Publish(cache);
+        return freeNodes.load(memory_order_relaxed);
+    }
+    static long LiveNodes() {
+        Publish(cache);
+        return carvedNodes.load(memory_order_relaxed) - freeNodes.load(memory_order_relaxed);
+    }
+
+private:
+    static const int BatchSize = 64;              // 與全域池交換的批次大小
+    static const int CacheLimit = 4 * BatchSize;  // 每個執行緒最多快取的節點數
+    static const int PoolSlots = 256;             // 全域池的槽位數
+    static const int NodesPerSlab = 4096;         // 每個 slab 的節點數（BatchSize 的倍數）
+
+    // 一大塊連續的節點空間
+    struct Slab {
+        Slab* next;
+        Node nodes[NodesPerSlab];
+    };
+
+    // 執行緒專屬的節點快取，執行緒結束時交回全域池
+    struct ThreadCache {
+        Node* avail = nullptr;
+        int count = 0;
+        int published = 0;       // 已計入 freeNodes 的 count
+        int fresh = 0;           // 快取底部尚未交出的新切節點數（量測用）
+        Slab* slab = nullptr;    // 目前正在切割的 slab
+        int carved = NodesPerSlab; // slab 中已切出的節點數
+        ~ThreadCache();
+    };
+
+    static void Refill(ThreadCache& tc);
+    static void Spill(ThreadCache& tc);
+    static void Carve(ThreadCache& tc, int n);
+    static void Publish(ThreadCache& tc);
+    static void PushSlabs(Slab* first, Slab* last);
+    static void PushBatch(Node* first, int n);
+    static Node* PopBatch(int& n);
+
+    static inline thread_local ThreadCache cache;
+    static inline atomic<Node*> pool[PoolSlots];
+    static inline atomic<Slab*> slabs{nullptr};   // 所有 slab 串成的串列
+    static inline atomic<long> slabCount{0};
+    static inline atomic<long> carvedNodes{0};    // 已從 slab 切出的節點數
+    static inline atomic<long> freeNodes{0};      // 快取與全域池中的節點數
+    static inline mutex trimLock;                 // 只有 Trim() 使用
+    static inline mutex overflowLock;             // 全域池槽位全滿時才使用
+    static inline vector<Node*> overflow;
+    static inline atomic<int> overflowBatches{0};
+};
+
+// 將一批以 nullptr 結尾的節點放入全域池
+// 批次長度記在第一個節點的 Length 欄位（空閒節點的內容沒有用途）
+template <class Node, int Node::*Length, int Kind>
+void NodePool<Node, Length, Kind>::PushBatch(Node* first, int n) {
+    first->*Length = n;
+    for (int i = 0; i < PoolSlots; i++) {
+        Node* expected = nullptr;
+        if (pool[i].load(memory_order_relaxed) == nullptr &&
+            pool[i].compare_exchange_strong(expected, first, memory_order_release,
+                                            memory_order_relaxed))
+            return;
+    }
+
+    // 全域池已滿，放到溢位區
+    lock_guard<mutex> guard(overflowLock);
+    overflow.push_back(first);
+    overflowBatches.fetch_add(1, memory_order_relaxed);
+}
+
+// 從全域池取出一批節點，池為空時回傳 nullptr
+template <class Node, int Node::*Length, int Kind>
+Node* NodePool<Node, Length, Kind>::PopBatch(int& n) {
+    for (int i = 0; i < PoolSlots; i++) {
+        if (pool[i].load(memory_order_relaxed) == nullptr)
+            continue;
+        Node* first = pool[i].exchange(nullptr, memory_order_acquire);
+        if (first) {
+            n = first->*Length;
+            return first;
+        }
+    }
+
+    if (overflowBatches.load(memory_order_relaxed) == 0)
+        return nullptr;
+    lock_guard<mutex> guard(overflowLock);
+    if (overflow.empty())
+        return nullptr;
+    Node* first = overflow.back();
+    overflow.pop_back();
+    overflowBatches.fetch_sub(1, memory_order_relaxed);
+    n = first->*Length;
+    return first;
+}
+
+// 把本執行緒快取數量的變化計入 freeNodes
+// 節點在快取與全域池之間移動不影響總數，因此只在批次交換、整串回收
+// 與查詢統計時更新，逐一的 Get / Return 不需要原子操作
+template <class Node, int Node::*Length, int Kind>
+void NodePool<Node, Length, Kind>::Publish(ThreadCache& tc) {
+    if (tc.count != tc.published)
+        freeNodes.fetch_add(tc.count - tc.published, memory_order_relaxed);
+    tc.published = tc.count;
+}
+
+// 將一串 slab 接到 slab 串列的前端
+template <class Node, int Node::*Length, int Kind>
+void NodePool<Node, Length, Kind>::PushSlabs(Slab* first, Slab* last) {
+    Slab* expected = slabs.load(memory_order_relaxed);
+    do {
+        last->next = expected;
+    } while (!slabs.compare_exchange_weak(expected, first, memory_order_release,
+                                          memory_order_relaxed));
+}
+
+// 從本執行緒的 slab 依位址順序切出 n 個節點放入快取
+template <class Node, int Node::*Length, int Kind>
+void NodePool<Node, Length, Kind>::Carve(ThreadCache& tc, int n) {
+    if (tc.carved == NodesPerSlab) {
+        tc.slab = new Slab;
+        tc.carved = 0;
+        PushSlabs(tc.slab, tc.slab);
+        slabCount.fetch_add(1, memory_order_relaxed);
+        POLY_PROF_POOL(Kind, SlabAlloc, 1);
+    }
+    Node* first = tc.slab->nodes + tc.carved;
+    for (int i = 0; i < n - 1; i++)
+        first[i].link = &first[i + 1];
+    first[n - 1].link = tc.avail;
+    tc.avail = first;
+    tc.count += n;
+    tc.published += n;
+    tc.carved += n;
+    carvedNodes.fetch_add(n, memory_order_relaxed);
+    freeNodes.fetch_add(n, memory_order_relaxed);
+}
+
+// 快取用完：先向全域池要一批，池也空了才從 slab 切新節點
+template <class Node, int Node::*Length, int Kind>
+void NodePool<Node, Length, Kind>::Refill(ThreadCache& tc) {
+    Publish(tc);
+    int n;
+    Node* batch = PopBatch(n);
+    if (batch) {
+        if (n > BatchSize) {
+            // ReturnList 放入的整串節點：只取前 BatchSize 個，其餘放回全域池
+            Node* last = batch;
+            for (int i = 1; i < BatchSize; i++)
+                last = last->link;
+            PushBatch(last->link, n - BatchSize);
+            last->link = nullptr;
+            n = BatchSize;
+        }
+        tc.avail = batch;
+        tc.count = tc.published = n;
+    }
+    else {
+        Carve(tc, BatchSize);
+        tc.fresh = BatchSize;
+    }
+}
+
+// 快取超過上限：切下前 BatchSize 個節點交給全域池
+template <class Node, int Node::*Length, int Kind>
+void NodePool<Node, Length, Kind>::Spill(ThreadCache& tc) {
+    Node* first = tc.avail;
+    Node* last = first;
+    for (int i = 1; i < BatchSize; i++)
+        last = last->link;
+    tc.avail = last->link;
+    last->link = nullptr;
+
+    Publish(tc);
+    PushBatch(first, BatchSize);
+    tc.count -= BatchSize;
+    tc.published = tc.count;
+}
+
+template <class Node, int Node::*Length, int Kind>
+void NodePool<Node, Length, Kind>::ReturnList(Node* head, int n) {
+    ThreadCache& tc = cache;
+    POLY_PROF_POOL(Kind, Return, n);
+    Node* first = head->link;
+    if (tc.count + n <= CacheLimit) {
+        head->link = tc.avail;
+        tc.avail = first;
+        tc.count += n;
+        Publish(tc); // 整串只更新一次，不影響 O(1)
+        return;
+    }
+
+    // 超過快取上限：整串直接當成一批放入全域池
+    head->link = nullptr;
+    PushBatch(first, n);
+    freeNodes.fetch_add(n, memory_order_relaxed);
+}
+
+// 執行緒結束：slab 中尚未切出的部分與快取中的節點整批交回全域池
+template <class Node, int Node::*Length, int Kind>
+NodePool<Node, Length, Kind>::ThreadCache::~ThreadCache() {
+    if (carved < NodesPerSlab)
+        Carve(*this, NodesPerSlab - carved);
+    Publish(*this);
+    if (avail)
+        PushBatch(avail, count);
+    avail = nullptr;
+    count = published = fresh = 0;
+}
+
+template <class Node, int Node::*Length, int Kind>
+int NodePool<Node, Length, Kind>::Trim() {
+    lock_guard<mutex> guard(trimLock);
+    ThreadCache& tc = cache;
+    Publish(tc);
+
+    // 1. 收集本執行緒快取與全域池中的所有空閒節點
+    vector<Node*> freeList;
+    freeList.reserve(tc.count);
+    for (Node* p = tc.avail; p; p = p->link)
+        freeList.push_back(p);
+    tc.avail = nullptr;
+    tc.count = tc.published = tc.fresh = 0;
+    for (int i = 0; i < PoolSlots; i++) {
+        for (Node* p = pool[i].exchange(nullptr, memory_order_acquire); p; p = p->link)
+            freeList.push_back(p);
+    }
+    {
+        lock_guard<mutex> guard(overflowLock);
+        for (Node* first : overflow) {
+            for (Node* p = first; p; p = p->link)
+                freeList.push_back(p);
+        }
+        overflowBatches.fetch_sub((int)overflow.size(), memory_order_relaxed);
+        overflow.clear();
+    }
+
+    // 2. 依位址排序，統計每個 slab 中有多少空閒節點
+    less<const void*> before;
+    sort(freeList.begin(), freeList.end(), before);
+
+    vector<Slab*> all;
+    for (Slab* s = slabs.exchange(nullptr, memory_order_acquire); s; s = s->next)
+        all.push_back(s);
+    sort(all.begin(), all.end(), before);
+
+    vector<int> freeCount(all.size(), 0);
+    size_t k = 0;
+    for (Node* p : freeList) {
+        while (k + 1 < all.size() && !before(p, all[k + 1]))
+            k++;
+        freeCount[k]++;
+    }
+
+    // 3. 釋放完全空閒的 slab，其餘 slab 放回串列
+    Slab *keepFirst = nullptr, *keepLast = nullptr;
+    int released = 0;
+    for (size_t i = 0; i < all.size(); i++) {
+        if (freeCount[i] == NodesPerSlab)
+            continue;
+        all[i]->next = keepFirst;
+        keepFirst = all[i];
+        if (!keepLast)
+            keepLast = all[i];
+    }
+    if (keepFirst)
+        PushSlabs(keepFirst, keepLast);
+
+    // 4. 剩下的空閒節點依位址順序重新組成批次放回全域池
+    k = 0;
+    size_t i = 0;
+    while (i < freeList.size()) {
+        while (k + 1 < all.size() && !before(freeList[i], all[k + 1]))
+            k++;
+        if (freeCount[k] == NodesPerSlab) {
+            i += NodesPerSlab;
+            continue;
+        }
+        size_t n = 0;
+        Node *first = freeList[i], *last = first;
+        while (n < BatchSize && i < freeList.size() &&
+               (k + 1 >= all.size() || before(freeList[i], all[k + 1]))) {
+            freeList[i]->link = nullptr;
+            if (n)
+                last->link = freeList[i];
+            last = freeList[i];
+            i++;
+            n++;
+        }
+        PushBatch(first, (int)n);
+    }
+
+    for (size_t j = 0; j < all.size(); j++) {
+        if (freeCount[j] == NodesPerSlab) {
+            delete all[j];
+            released++;
+        }
+    }
+    slabCount.fetch_sub(released, memory_order_relaxed);
+    POLY_PROF_POOL(Kind, SlabRelease, released);
+    carvedNodes.fetch_sub((long)released * NodesPerSlab, memory_order_relaxed);
+    freeNodes.fetch_sub((long)released * NodesPerSlab, memory_order_relaxed);
+    return released;
+}
+
 struct PolyNode {
     int coef;        // 係數
     int exp;         // 指數
     PolyNode* link;  // 指向下一個節點
 };
 
-class AvailableList {
+// 項目節點的可用空間串列
+class AvailableList : public NodePool<PolyNode, &PolyNode::coef, polyprof::PoolNodes> {
 public:
-    // 取得一個節點（優先從可用串列中取）
+    // 取得一個節點並設定內容
     static PolyNode* GetNode(int c = 0, int e = 0) {
-        if (avail) {
-            PolyNode* p = avail;
-            avail = avail->link;
-            p->coef = c;
-            p->exp = e;
-            p->link = nullptr;
-            return p;
-        }
-        return new PolyNode{c, e, nullptr};
+        PolyNode* p = Get();
+        p->coef = c;
+        p->exp = e;
+        p->link = nullptr;
+        return p;
     }
 
-    // 回收節點至可用串列
+    // 回收節點
     static void ReturnNode(PolyNode* p) {
-        p->link = avail;
-        avail = p;
+        Return(p);
     }
-
-private:
-    static PolyNode* avail;
 };
 
-// 初始化可用空間串列
-PolyNode* AvailableList::avail = nullptr;
-
 /* =================================================
    Polynomial 類別（使用循環鏈結串列 + 表頭節點）
+
+   項目串列以參考計數的方式共用（copy-on-write）：
+   複製只增加計數，不複製節點；所有運算都產生新的串列，
+   不會修改共用中的串列。計數為 atomic，唯讀的多項式
+   可以同時交給多個執行緒使用。
+
+   空的多項式（預設建構、被移走的物件）共用一份靜態的
+   空串列，不配置任何記憶體，也不更動計數；PolyRep 本身
+   同樣由 NodePool 配置與回收。
    ================================================= */
 
+// 共用的項目串列
+struct PolyRep {
+    atomic<int> refs;  // 共用此串列的 Polynomial 數
+    int terms;         // 項目節點數（不含表頭），供整串回收使用
+    PolyNode* head;    // 表頭節點（header node）
+    PolyRep* link;     // 在可用空間串列中時指向下一個
+};
+
+typedef NodePool<PolyRep, &PolyRep::terms, polyprof::PoolReps> AvailableRepList;
+
 class Polynomial {
 public:
     Polynomial();                                // 預設建構子
     Polynomial(const Polynomial& a);             // 複製建構子
+    Polynomial(Polynomial&& a) noexcept;         // 移動建構子
     ~Polynomial();                               // 解構子
 
     const Polynomial& operator=(const Polynomial& a); // 指派運算子
+    const Polynomial& operator=(Polynomial&& a) noexcept; // 移動指派運算子
 
     Polynomial operator+(const Polynomial& b) const; // 加法
     Polynomial operator-(const Polynomial& b) const; // 減法
@@ -64,62 +452,87 @@ public:
     friend ostream& operator<<(ostream& os, const Polynomial& x); // 輸出
 
 private:
-    PolyNode* head;  // 表頭節點（header node）
+    explicit Polynomial(PolyRep* r) : rep(r) {}  // 接手一份串列
+    Polynomial AddSub(const Polynomial& b, int sign) const; // 加法 / 減法共用的合併
+    static PolyRep* NewRep();                    // 取得新的空串列（可以寫入）
+    static void Retain(PolyRep* r);              // 增加計數
+    static void Release(PolyRep* r);             // 減少計數，最後一個使用者負責回收
+
+    PolyRep* rep;    // 共用的項目串列
+
+    static PolyNode emptyHead;  // 共用空串列的表頭
+    static PolyRep emptyRep;    // 共用空串列（不計數、不回收、不可寫入）
 };
 
+PolyNode Polynomial::emptyHead = {0, 0, &Polynomial::emptyHead};
+PolyRep Polynomial::emptyRep = {{0}, 0, &Polynomial::emptyHead, nullptr};
+
 /* =================================================
    建構子與解構子
    ================================================= */
 
-// 建立空的多項式（只有表頭節點）
+// 建立空的多項式：共用靜態的空串列，不配置記憶體
 Polynomial::Polynomial() {
-    head = AvailableList::GetNode();
-    head->link = head; // 循環
+    rep = &emptyRep;
 }
 
-// 複製建構子
+// 複製建構子：共用同一份串列，O(1)
 Polynomial::Polynomial(const Polynomial& a) {
-    head = AvailableList::GetNode();
-    head->link = head;
+    rep = a.rep;
+    Retain(rep);
+}
 
-    PolyNode* rear = head;
-    for (PolyNode* p = a.head->link; p != a.head; p = p->link) {
-        rear->link = AvailableList::GetNode(p->coef, p->exp);
-        rear = rear->link;
-    }
-    rear->link = head;
+// 移動建構子：接手 a 的串列，a 改為共用空串列
+Polynomial::Polynomial(Polynomial&& a) noexcept {
+    rep = a.rep;
+    a.rep = &emptyRep;
 }
 
-// 解構子（回收所有節點）
+// 解構子
 Polynomial::~Polynomial() {
-    PolyNode* p = head->link;
-    while (p != head) {
-        PolyNode* temp = p;
-        p = p->link;
-        AvailableList::ReturnNode(temp);
+    Release(rep);
+}
+
+// 只有表頭節點的新串列，計數為 1
+PolyRep* Polynomial::NewRep() {
+    PolyRep* r = AvailableRepList::Get();
+    r->refs.store(1, memory_order_relaxed);
+    r->terms = 0;
+    r->head = AvailableList::GetNode();
+    r->head->link = r->head; // 循環
+    return r;
+}
+
+void Polynomial::Retain(PolyRep* r) {
+    if (r != &emptyRep)
+        r->refs.fetch_add(1, memory_order_relaxed);
+}
+
+void Polynomial::Release(PolyRep* r) {
+    if (r != &emptyRep && r->refs.fetch_sub(1, memory_order_acq_rel) == 1) {
+        AvailableList::ReturnList(r->head, r->terms + 1); // 整串一次回收，O(1)
+        AvailableRepList::Return(r);
     }
-    AvailableList::ReturnNode(head);
 }
 
 /* =================================================
    指派運算子
    ================================================= */
 
+// 改為共用 a 的串列，原本的串列在沒有人使用時才回收
 const Polynomial& Polynomial::operator=(const Polynomial& a) {
-    if (this == &a) return *this;
+    if (rep == a.rep) return *this;
 
-    this->~Polynomial(); // 先清空原本資料
+    Retain(a.rep);
+    Release(rep);
+    rep = a.rep;
 
-    head = AvailableList::GetNode();
-    head->link = head;
-
-    PolyNode* rear = head;
-    for (PolyNode* p = a.head->link; p != a.head; p = p->link) {
-        rear->link = AvailableList::GetNode(p->coef, p->exp);
-        rear = rear->link;
-    }
-    rear->link = head;
+    return *this;
+}
 
+// 移動指派：交換串列，原本的串列隨 a 解構時回收
+const Polynomial& Polynomial::operator=(Polynomial&& a) noexcept {
+    swap(rep, a.rep);
     return *this;
 }
 
@@ -127,30 +540,66 @@ const Polynomial& Polynomial::operator=(const Polynomial& a) {
    輸入 / 輸出
    ================================================= */
 
-// (a) 輸入多項式：n c1 e1 c2 e2 ... cn en
-istream& operator>>(istream& is, Polynomial& x) {
+// 讀入 n c1 e1 c2 e2 ... cn en 到 terms（每一項為 (指數, 係數)）
+// 項目可以任意順序：依指數遞減排序，合併指數相同的項並去除係數為 0 的項，
+// 因為加法與乘法的合併都假設項目依指數遞減且指數不重複。
+// 項數為負或輸入不完整時回傳 false（並設定 failbit）
+bool ReadTerms(istream& is, vector<pair<int, int>>& terms) {
     int n, c, e;
-    is >> n;
-
-    x.head = AvailableList::GetNode();
-    x.head->link = x.head;
+    if (!(is >> n))
+        return false;
+    if (n < 0) {
+        is.setstate(ios::failbit); // 項數不可為負
+        return false;
+    }
 
-    PolyNode* rear = x.head;
+    terms.clear();
     for (int i = 0; i < n; i++) {
-        is >> c >> e;
-        rear->link = AvailableList::GetNode(c, e);
+        if (!(is >> c >> e))
+            return false;
+        terms.push_back({e, c});
+    }
+
+    sort(terms.begin(), terms.end(), greater<pair<int, int>>());
+    size_t k = 0;
+    for (size_t i = 0; i < terms.size();) {
+        int exp = terms[i].first, sum = 0;
+        for (; i < terms.size() && terms[i].first == exp; i++)
+            sum += terms[i].second;
+        if (sum)
+            terms[k++] = {exp, sum};
+    }
+    terms.resize(k);
+    return true;
+}
+
+// (a) 輸入多項式：n c1 e1 c2 e2 ... cn en（格式見 ReadTerms）
+// 一律建立新的串列，不影響其他共用原本串列的多項式；輸入失敗時 x 不變
+istream& operator>>(istream& is, Polynomial& x) {
+    vector<pair<int, int>> terms;
+    if (!ReadTerms(is, terms))
+        return is;
+
+    Polynomial in(Polynomial::NewRep());
+    PolyNode* rear = in.rep->head;
+    for (auto& t : terms) {
+        rear->link = AvailableList::GetNode(t.second, t.first);
         rear = rear->link;
     }
-    rear->link = x.head;
+    rear->link = in.rep->head;
+    in.rep->terms = (int)terms.size();
+
+    x = move(in);
     return is;
 }
 
 // (b) 輸出多項式
 ostream& operator<<(ostream& os, const Polynomial& x) {
-    PolyNode* p = x.head->link;
+    PolyNode* head = x.rep->head;
+    PolyNode* p = head->link;
     bool first = true;
 
-    while (p != x.head) {
+    while (p != head) {
         if (!first && p->coef > 0)
             os << "+";
         os << p->coef << "x^" << p->exp;
@@ -164,17 +613,20 @@ ostream& operator<<(ostream& os, const Polynomial& x) {
    多項式運算
    ================================================= */
 
-// (f) 加法
-Polynomial Polynomial::operator+(const Polynomial& b) const {
-    Polynomial c;
-    PolyNode *pa = head->link, *pb = b.head->link, *pc = c.head;
+// 合併 *this 與 sign * b（sign 為 1 或 -1）
+Polynomial Polynomial::AddSub(const Polynomial& b, int sign) const {
+    Polynomial c(NewRep());
+    PolyNode *ha = rep->head, *hb = b.rep->head;
+    PolyNode *pa = ha->link, *pb = hb->link, *pc = c.rep->head;
+    int n = 0;
 
-    while (pa != head && pb != b.head) {
+    while (pa != ha && pb != hb) {
         if (pa->exp == pb->exp) {
-            int sum = pa->coef + pb->coef;
+            int sum = pa->coef + sign * pb->coef;
             if (sum) {
                 pc->link = AvailableList::GetNode(sum, pa->exp);
                 pc = pc->link;
+                n++;
             }
             pa = pa->link;
             pb = pb->link;
@@ -182,75 +634,512 @@ Polynomial Polynomial::operator+(const Polynomial& b) const {
         else if (pa->exp > pb->exp) {
             pc->link = AvailableList::GetNode(pa->coef, pa->exp);
             pc = pc->link;
+            n++;
             pa = pa->link;
         }
         else {
-            pc->link = AvailableList::GetNode(pb->coef, pb->exp);
+            pc->link = AvailableList::GetNode(sign * pb->coef, pb->exp);
             pc = pc->link;
+            n++;
             pb = pb->link;
         }
     }
 
-    for (; pa != head; pa = pa->link) {
+    for (; pa != ha; pa = pa->link) {
         pc->link = AvailableList::GetNode(pa->coef, pa->exp);
         pc = pc->link;
+        n++;
     }
 
-    for (; pb != b.head; pb = pb->link) {
-        pc->link = AvailableList::GetNode(pb->coef, pb->exp);
+    for (; pb != hb; pb = pb->link) {
+        pc->link = AvailableList::GetNode(sign * pb->coef, pb->exp);
         pc = pc->link;
+        n++;
     }
 
-    pc->link = c.head;
+    pc->link = c.rep->head;
+    c.rep->terms = n;
     return c;
 }
 
-// (g) 減法
+// (f) 加法
+Polynomial Polynomial::operator+(const Polynomial& b) const {
+    POLY_PROF_SCOPE(OpPlus);
+    return AddSub(b, 1);
+}
+
+// (g) 減法（合併時直接把 b 的係數取負，不必先複製 b）
 Polynomial Polynomial::operator-(const Polynomial& b) const {
-    Polynomial negB = b;
-    for (PolyNode* p = negB.head->link; p != negB.head; p = p->link)
-        p->coef = -p->coef;
-    return *this + negB;
+    POLY_PROF_SCOPE(OpMinus);
+    return AddSub(b, -1);
 }
 
 // (h) 乘法
+// a 的每一項乘上 b 得到一列指數遞減的部分積，直接合併進累加結果 c：
+// 指數相同就地修改係數（變為 0 時回收節點），否則在正確位置插入新節點。
+// c 同樣依指數遞減排列，每一列只需從頭走訪 c 一次，
+// 不再產生暫存多項式，配置的節點數只和結果的項數有關。
 Polynomial Polynomial::operator*(const Polynomial& b) const {
-    Polynomial c;
-
-    for (PolyNode* pa = head->link; pa != head; pa = pa->link) {
-        Polynomial temp;
-        PolyNode* pt = temp.head;
-
-        for (PolyNode* pb = b.head->link; pb != b.head; pb = pb->link) {
-            pt->link = AvailableList::GetNode(
-                pa->coef * pb->coef,
-                pa->exp + pb->exp
-            );
-            pt = pt->link;
+    POLY_PROF_SCOPE(OpTimes);
+    Polynomial c(NewRep());
+    PolyNode *ha = rep->head, *hb = b.rep->head, *hc = c.rep->head;
+    int n = 0;
+
+    for (PolyNode* pa = ha->link; pa != ha; pa = pa->link) {
+        PolyNode* prev = hc; // 插入位置的前一個節點
+
+        for (PolyNode* pb = hb->link; pb != hb; pb = pb->link) {
+            int coef = pa->coef * pb->coef;
+            int exp = pa->exp + pb->exp;
+
+            PolyNode* cur = prev->link;
+            while (cur != hc && cur->exp > exp) {
+                prev = cur;
+                cur = cur->link;
+            }
+
+            if (cur != hc && cur->exp == exp) {
+                cur->coef += coef;
+                if (cur->coef == 0) {
+                    prev->link = cur->link;
+                    AvailableList::ReturnNode(cur);
+                    n--;
+                }
+            }
+            else if (coef) {
+                PolyNode* node = AvailableList::GetNode(coef, exp);
+                node->link = cur;
+                prev->link = node;
+                prev = node;
+                n++;
+            }
         }
-        pt->link = temp.head;
-        c = c + temp;
     }
+    c.rep->terms = n;
     return c;
 }
 
 // (i) 計算多項式在 x 的值
 float Polynomial::Evaluate(float x) const {
+    POLY_PROF_SCOPE(OpEvaluate);
     float result = 0.0f;
+    PolyNode* head = rep->head;
     for (PolyNode* p = head->link; p != head; p = p->link)
         result += p->coef * pow(x, p->exp);
     return result;
 }
 
 /* =================================================
-   主程式（測試用）
+   BlockPolynomial 類別（展開式鏈結串列 + 表頭區塊）
+
+   與 Polynomial 相同的介面與循環串列 + 表頭設計，
+   但每個節點（區塊）依指數遞減連續存放最多 BlockTerms 項，
+   並記錄已使用的項數。走訪時大部分時間都在陣列內前進，
+   每 BlockTerms 項才跟一次指標，快取失誤大幅減少；
+   區塊之間仍以指標相連，整串回收依然是 O(1)。
+
+   區塊與項目節點一樣由 NodePool 管理；空的多項式共用
+   一個靜態的空表頭區塊，建構與移動都不需要配置。
    ================================================= */
 
-int main() {
+const int BlockTerms = 14; // 每個區塊的項數（整個區塊 128 bytes）
+
+struct BlockTerm {
+    int coef;  // 係數
+    int exp;   // 指數
+};
+
+struct TermBlock {
+    int count;                    // 已使用的項數
+    BlockTerm term[BlockTerms];   // 依指數遞減排列的項目
+    TermBlock* link;              // 指向下一個區塊
+};
+
+// 區塊的可用空間串列（與項目節點相同的執行緒快取、全域池與 slab）
+class AvailableBlockList : public NodePool<TermBlock, &TermBlock::count, polyprof::PoolBlocks> {
+public:
+    // 取得一個空區塊
+    static TermBlock* GetBlock() {
+        TermBlock* b = Get();
+        b->count = 0;
+        b->link = nullptr;
+        return b;
+    }
+
+    // 回收區塊
+    static void ReturnBlock(TermBlock* b) {
+        Return(b);
+    }
+};
+
+class BlockPolynomial {
+public:
+    BlockPolynomial();                                     // 預設建構子
+    BlockPolynomial(const BlockPolynomial& a);             // 複製建構子
+    BlockPolynomial(BlockPolynomial&& a) noexcept;         // 移動建構子
+    ~BlockPolynomial();                                    // 解構子
+
+    const BlockPolynomial& operator=(const BlockPolynomial& a); // 指派運算子
+    const BlockPolynomial& operator=(BlockPolynomial&& a) noexcept; // 移動指派運算子
+
+    BlockPolynomial operator+(const BlockPolynomial& b) const; // 加法
+    BlockPolynomial operator-(const BlockPolynomial& b) const; // 減法
+    BlockPolynomial operator*(const BlockPolynomial& b) const; // 乘法
+
+    float Evaluate(float x) const;                         // 計算多項式值
+
+    friend istream& operator>>(istream& is, BlockPolynomial& x); // 輸入
+    friend ostream& operator<<(ostream& os, const BlockPolynomial& x); // 輸出
+
+private:
+    explicit BlockPolynomial(TermBlock* h) : head(h), blocks(1) {} // 接手一個表頭區塊
+    static TermBlock* NewHead();                           // 取得新的表頭區塊（可以寫入）
+    TermBlock* Append(TermBlock* rear, int c, int e);      // 在串列尾端加入一項
+    BlockPolynomial Merge(const BlockPolynomial& b, int sign) const; // 加法 / 減法共用的合併
+
+    // 乘法就地合併時的位置：blk 的第 i 項（blk 為表頭時代表串列尾端），
+    // prev 為 blk 的前一個區塊
+    struct Cursor {
+        TermBlock* prev;
+        TermBlock* blk;
+        int i;
+    };
+    void Seek(Cursor& at, int e) const;                    // 前進到第一個指數不大於 e 的項目
+    void Insert(Cursor& at, int c, int e);                 // 在游標處插入一項
+    void Erase(Cursor& at);                                // 刪除游標處的項目
+
+    TermBlock* head; // 表頭區塊（不存放項目）
+    int blocks;      // 區塊數（含表頭），供整串回收使用
+
+    static TermBlock emptyHead; // 空多項式共用的表頭區塊（不回收、不可寫入）
+};
+
+TermBlock BlockPolynomial::emptyHead = {0, {}, &BlockPolynomial::emptyHead};
+
+// 建立空的多項式：共用靜態的空表頭，不配置記憶體
+BlockPolynomial::BlockPolynomial() {
+    head = &emptyHead;
+    blocks = 1;
+}
+
+TermBlock* BlockPolynomial::NewHead() {
+    TermBlock* h = AvailableBlockList::GetBlock();
+    h->link = h; // 循環
+    return h;
+}
+
+// 複製建構子：整個區塊一起複製
+BlockPolynomial::BlockPolynomial(const BlockPolynomial& a) : BlockPolynomial() {
+    if (a.head->link == a.head)
+        return;
+    head = NewHead();
+    TermBlock* rear = head;
+    for (TermBlock* p = a.head->link; p != a.head; p = p->link) {
+        TermBlock* q = AvailableBlockList::GetBlock();
+        q->count = p->count;
+        copy(p->term, p->term + p->count, q->term);
+        rear->link = q;
+        rear = q;
+        blocks++;
+    }
+    rear->link = head;
+}
+
+// 移動建構子：接手 a 的串列，a 改為共用空表頭
+BlockPolynomial::BlockPolynomial(BlockPolynomial&& a) noexcept {
+    head = a.head;
+    blocks = a.blocks;
+    a.head = &emptyHead;
+    a.blocks = 1;
+}
+
+BlockPolynomial::~BlockPolynomial() {
+    if (head != &emptyHead)
+        AvailableBlockList::ReturnList(head, blocks);
+}
+
+const BlockPolynomial& BlockPolynomial::operator=(const BlockPolynomial& a) {
+    if (this == &a) return *this;
+    BlockPolynomial temp(a);
+    swap(head, temp.head);
+    swap(blocks, temp.blocks);
+    return *this;
+}
+
+const BlockPolynomial& BlockPolynomial::operator=(BlockPolynomial&& a) noexcept {
+    swap(head, a.head);
+    swap(blocks, a.blocks);
+    return *this;
+}
+
+// 在 rear 之後加入一項；rear 為表頭或已滿時接上新區塊，回傳新的尾端區塊
+// 呼叫者最後需自行把尾端區塊接回表頭
+TermBlock* BlockPolynomial::Append(TermBlock* rear, int c, int e) {
+    if (rear == head || rear->count == BlockTerms) {
+        TermBlock* q = AvailableBlockList::GetBlock();
+        rear->link = q;
+        rear = q;
+        blocks++;
+    }
+    rear->term[rear->count].coef = c;
+    rear->term[rear->count].exp = e;
+    rear->count++;
+    return rear;
+}
+
+// (a) 輸入多項式：n c1 e1 c2 e2 ... cn en（格式見 ReadTerms），輸入失敗時 x 不變
+istream& operator>>(istream& is, BlockPolynomial& x) {
+    vector<pair<int, int>> terms;
+    if (!ReadTerms(is, terms))
+        return is;
+
+    BlockPolynomial in(BlockPolynomial::NewHead());
+    TermBlock* rear = in.head;
+    for (auto& t : terms)
+        rear = in.Append(rear, t.second, t.first);
+    rear->link = in.head;
+
+    x = move(in);
+    return is;
+}
+
+// (b) 輸出多項式
+ostream& operator<<(ostream& os, const BlockPolynomial& x) {
+    bool first = true;
+    for (TermBlock* p = x.head->link; p != x.head; p = p->link) {
+        for (int i = 0; i < p->count; i++) {
+            if (!first && p->term[i].coef > 0)
+                os << "+";
+            os << p->term[i].coef << "x^" << p->term[i].exp;
+            first = false;
+        }
+    }
+    return os;
+}
+
+// 合併 *this 與 sign * b（sign 為 1 或 -1），產生新的多項式
+BlockPolynomial BlockPolynomial::Merge(const BlockPolynomial& b, int sign) const {
+    BlockPolynomial c(NewHead());
+    TermBlock* rear = c.head;
+    TermBlock *ba = head->link, *bb = b.head->link;
+    int ia = 0, ib = 0;
+
+    // (區塊, 索引) 前進到下一項；區塊只在加入項目時建立，不會是空的
+    auto next = [](TermBlock*& blk, int& i) {
+        if (++i == blk->count) {
+            blk = blk->link;
+            i = 0;
+        }
+    };
 
+    while (ba != head && bb != b.head) {
+        const BlockTerm& ta = ba->term[ia];
+        const BlockTerm& tb = bb->term[ib];
+        if (ta.exp == tb.exp) {
+            int sum = ta.coef + sign * tb.coef;
+            if (sum)
+                rear = c.Append(rear, sum, ta.exp);
+            next(ba, ia);
+            next(bb, ib);
+        }
+        else if (ta.exp > tb.exp) {
+            rear = c.Append(rear, ta.coef, ta.exp);
+            next(ba, ia);
+        }
+        else {
+            rear = c.Append(rear, sign * tb.coef, tb.exp);
+            next(bb, ib);
+        }
+    }
+
+    for (; ba != head; next(ba, ia))
+        rear = c.Append(rear, ba->term[ia].coef, ba->term[ia].exp);
+
+    for (; bb != b.head; next(bb, ib))
+        rear = c.Append(rear, sign * bb->term[ib].coef, bb->term[ib].exp);
+
+    rear->link = c.head;
+    return c;
+}
+
+// (f) 加法
+BlockPolynomial BlockPolynomial::operator+(const BlockPolynomial& b) const {
+    POLY_PROF_SCOPE(OpPlus);
+    return Merge(b, 1);
+}
+
+// (g) 減法
+BlockPolynomial BlockPolynomial::operator-(const BlockPolynomial& b) const {
+    POLY_PROF_SCOPE(OpMinus);
+    return Merge(b, -1);
+}
+
+void BlockPolynomial::Seek(Cursor& at, int e) const {
+    while (at.blk != head) {
+        while (at.i < at.blk->count && at.blk->term[at.i].exp > e)
+            at.i++;
+        if (at.i < at.blk->count)
+            return;
+        at.prev = at.blk;
+        at.blk = at.blk->link;
+        at.i = 0;
+    }
+}
+
+// 插入後游標停在新項目上（或其後），之後的項目指數較小，仍可繼續往後找
+void BlockPolynomial::Insert(Cursor& at, int c, int e) {
+    TermBlock* blk = at.blk;
+
+    // 插在區塊開頭或串列尾端：前一個區塊還有空間就直接接在它的尾端，不必搬移
+    if ((blk == head || at.i == 0) && at.prev != head && at.prev->count < BlockTerms) {
+        at.prev->term[at.prev->count].coef = c;
+        at.prev->term[at.prev->count].exp = e;
+        at.prev->count++;
+        return;
+    }
+
+    // 串列尾端：接上新區塊
+    if (blk == head) {
+        TermBlock* q = AvailableBlockList::GetBlock();
+        q->term[0].coef = c;
+        q->term[0].exp = e;
+        q->count = 1;
+        q->link = head;
+        at.prev->link = q;
+        at.prev = q;
+        blocks++;
+        return;
+    }
+
+    // 區塊已滿：後半移到新區塊，再插入到正確的一半
+    if (blk->count == BlockTerms) {
+        const int half = BlockTerms / 2;
+        TermBlock* q = AvailableBlockList::GetBlock();
+        copy(blk->term + half, blk->term + BlockTerms, q->term);
+        q->count = BlockTerms - half;
+        blk->count = half;
+        q->link = blk->link;
+        blk->link = q;
+        blocks++;
+        if (at.i > half) {
+            at.prev = blk;
+            at.blk = blk = q;
+            at.i -= half;
+        }
+    }
+
+    copy_backward(blk->term + at.i, blk->term + blk->count, blk->term + blk->count + 1);
+    blk->term[at.i].coef = c;
+    blk->term[at.i].exp = e;
+    blk->count++;
+}
+
+// 刪除後游標指向原本的下一項；區塊變空時立即回收
+void BlockPolynomial::Erase(Cursor& at) {
+    TermBlock* blk = at.blk;
+    copy(blk->term + at.i + 1, blk->term + blk->count, blk->term + at.i);
+    if (--blk->count == 0) {
+        at.prev->link = blk->link;
+        at.blk = blk->link;
+        at.i = 0;
+        AvailableBlockList::ReturnBlock(blk);
+        blocks--;
+    }
+}
+
+// (h) 乘法
+// a 的每一項乘上 b 得到一列指數遞減的部分積，直接合併進累加結果 c：
+// 指數相同就地修改係數（變為 0 時移除，區塊變空即回收），否則在區塊內插入，
+// 區塊已滿時分成兩半。每一列只需從頭走訪 c 一次，不產生暫存多項式。
+BlockPolynomial BlockPolynomial::operator*(const BlockPolynomial& b) const {
+    POLY_PROF_SCOPE(OpTimes);
+    BlockPolynomial c(NewHead());
+
+    for (TermBlock* pa = head->link; pa != head; pa = pa->link) {
+        for (int ia = 0; ia < pa->count; ia++) {
+            // 先取出 a 的這一項：寫入 c 時編譯器無法確定不會改到 a、b，放在區域變數才不必重讀
+            const int ac = pa->term[ia].coef, ae = pa->term[ia].exp;
+            Cursor at = {c.head, c.head->link, 0};
+
+            for (TermBlock* pb = b.head->link; pb != b.head; pb = pb->link) {
+                const int nb = pb->count;
+                for (int ib = 0; ib < nb; ib++) {
+                    int coef = ac * pb->term[ib].coef;
+                    int exp = ae + pb->term[ib].exp;
+
+                    // 稠密的情況下游標所在的項目通常就是目標，不必呼叫 Seek
+                    if (at.blk == c.head || at.i >= at.blk->count || at.blk->term[at.i].exp > exp)
+                        c.Seek(at, exp);
+                    if (at.blk != c.head && at.blk->term[at.i].exp == exp) {
+                        at.blk->term[at.i].coef += coef;
+                        if (at.blk->term[at.i].coef == 0)
+                            c.Erase(at);
+                    }
+                    else if (coef) {
+                        c.Insert(at, coef, exp);
+                    }
+                }
+            }
+        }
+    }
+    return c;
+}
+
+// (i) 計算多項式在 x 的值
+float BlockPolynomial::Evaluate(float x) const {
+    POLY_PROF_SCOPE(OpEvaluate);
+    float result = 0.0f;
+    for (TermBlock* p = head->link; p != head; p = p->link) {
+        for (int i = 0; i < p->count; i++)
+            result += p->term[i].coef * pow(x, p->term[i].exp);
+    }
+    return result;
+}
+
+// 編譯時加上 -DPOLY_UNROLLED 即改用展開式串列版本
+#ifdef POLY_UNROLLED
+typedef BlockPolynomial PolyImpl;
+#else
+typedef Polynomial PolyImpl;
+#endif
+
+/* =================================================
+   批次指令模式（指令說明見 common/poly_script.h）
+   ================================================= */
+
+int RunScript(istream& in) {
+    return RunPolyScript<PolyImpl>(
+        in,
+        [](PolyImpl& p, istream& is) { return static_cast<bool>(is >> p); },
+        [](const PolyImpl& a, const PolyImpl& b) { return a + b; },
+        [](const PolyImpl& a, const PolyImpl& b) { return a - b; },
+        [](const PolyImpl& a, const PolyImpl& b) { return a * b; },
+        [](const PolyImpl& a, float x) { return a.Evaluate(x); });
+}
+
+/* =================================================
+   主程式（測試用）
+   執行時給定指令檔（或 - 代表標準輸入）即進入批次模式
+   ================================================= */
+
+int main(int argc, char* argv[]) {
+#ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
-    Polynomial p1, p2;
+#endif
+
+    if (argc > 1) {
+        if (string(argv[1]) == "-")
+            return RunScript(cin);
+        ifstream script(argv[1]);
+        if (!script) {
+            cerr << "無法開啟指令檔：" << argv[1] << endl;
+            return 1;
+        }
+        return RunScript(script);
+    }
+
+    PolyImpl p1, p2;
 
     cout << "請輸入多項式 p1(格式:n c1 e1 ... cn en):";
     cin >> p1;
@@ -0,0 +1,64 @@
+/* =================================================
+   HW1 Problem 1：Ackermann 函數 benchmark
+   比較遞迴與非遞迴（手動堆疊）兩種版本，
+   非遞迴版本的堆疊配置次數由 bench_malloc 統計
+   ================================================= */
+
+#include "bench_util.h"
+
+/* 直接引入原始程式，主程式改名以免與 benchmark 衝突 */
+#define malloc(n) bench_malloc(n)
+#define main ackermann_main
+#include "../HW1/Problem 1/mian.c"
+#undef main
+#undef malloc
+
+typedef unsigned long long (*AckFn)(unsigned long long, unsigned long long);
+
+static void run_case(const BenchOptions* opt, const char* impl, AckFn fn,
+                     unsigned long long m, unsigned long long n) {
+    char op[32];
+    if (!bench_case_begin(opt))
+        return;
+    sprintf(op, "A(%llu,%llu)", m, n);
+
+    unsigned long long value = 0;
+    long iters = 0;
+    long long allocs = bench_alloc_count;
+    double start = bench_now(), now;
+    do {
+        value = fn(m, n);
+        ++iters;
+        now = bench_now();
+    } while (now - start < opt->minTime);
+
+    BenchResult r = {0};
+    r.benchmark = "ackermann";
+    r.impl = impl;
+    r.op = op;
+    r.unit = "evaluation";
+    r.size = (long)n;
+    r.iterations = iters;
+    r.opsPerIteration = 1;
+    r.seconds = now - start;
+    r.allocations = bench_alloc_count - allocs;
+    r.checksum = (double)value;
+    bench_emit(opt, &r);
+    bench_case_end(opt);
+}
+
+int main(int argc, char** argv) {
+    static const unsigned long long cases[][2] = {
+        {1, 1000}, {2, 500}, {3, 6}, {3, 8}, {3, 10}
+    };
+    BenchOptions opt;
+    bench_parse_args(argc, argv, &opt);
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        run_case(&opt, "recursive", ack_recursive, cases[i][0], cases[i][1]);
+        run_case(&opt, "iterative", ack_iterative, cases[i][0], cases[i][1]);
+    }
+
+    bench_finish(&opt);
+    return 0;
+}
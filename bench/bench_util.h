@@ -0,0 +1,246 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+/* =================================================
+   Benchmark 共用工具（C 與 C++ 皆可使用）
+
+   - 計時、峰值 RSS、配置次數統計
+   - 每個案例在獨立的子行程中執行，峰值 RSS 只反映該案例
+   - 可重現的測試資料：相同的種子在每個 benchmark 中
+     產生完全相同的多項式，HW2 與 HW3 因此可以直接比較
+   - 每筆結果輸出為一行 JSON（JSON Lines），
+     多個 benchmark 的輸出可以直接串接
+
+   每個 benchmark 執行檔只由一個 .c / .cpp 組成，
+   本檔只會被引入一次。
+
+   共同參數：
+     -o 檔案   輸出到檔案（覆寫）
+     -a 檔案   輸出到檔案（附加）
+     -s 倍數   多項式大小的倍數（預設 1）
+     -t 秒數   每個案例至少執行的時間（預設 0.2）
+   ================================================= */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+typedef struct {
+    FILE* out;        /* 輸出位置 */
+    int scale;        /* 多項式大小倍數 */
+    double minTime;   /* 每個案例至少執行的秒數 */
+} BenchOptions;
+
+typedef struct {
+    const char* benchmark;  /* benchmark 名稱 */
+    const char* impl;       /* 實作（例如 recursive、hw2_array） */
+    const char* op;         /* 運算 */
+    const char* shape;      /* 輸入型態（例如 sparse / dense），可為 NULL */
+    const char* unit;       /* ops_per_sec 的單位 */
+    long size;              /* 輸入規模 */
+    long iterations;        /* 執行次數 */
+    double opsPerIteration; /* 每次執行相當於幾個 unit */
+    double seconds;         /* 總執行時間 */
+    long long allocations;  /* 量測期間的配置次數 */
+    double checksum;        /* 結果摘要，用來確認不同實作的結果一致 */
+} BenchResult;
+
+/* 量測期間的配置次數（由 bench_malloc 或 operator new 累加） */
+static long long bench_alloc_count = 0;
+
+static inline void* bench_malloc(size_t n) {
+    bench_alloc_count++;
+    return malloc(n);
+}
+
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 行程目前為止的峰值 RSS（KB）；在 bench_case_begin 的子行程中即為該案例的峰值 */
+static inline long bench_peak_rss_kb(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+static inline void bench_usage(const char* prog) {
+    fprintf(stderr, "用法：%s [-o 檔案 | -a 檔案] [-s 倍數] [-t 秒數]\n", prog);
+    exit(2);
+}
+
+static inline void bench_parse_args(int argc, char** argv, BenchOptions* opt) {
+    opt->out = stdout;
+    opt->scale = 1;
+    opt->minTime = 0.2;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc)
+            bench_usage(argv[0]);
+        if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "-a") == 0) {
+            opt->out = fopen(argv[i + 1], argv[i][1] == 'o' ? "w" : "a");
+            if (!opt->out) {
+                fprintf(stderr, "無法開啟輸出檔：%s\n", argv[i + 1]);
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "-s") == 0) {
+            opt->scale = atoi(argv[i + 1]);
+            if (opt->scale < 1)
+                bench_usage(argv[0]);
+        } else if (strcmp(argv[i], "-t") == 0) {
+            opt->minTime = atof(argv[i + 1]);
+        } else {
+            bench_usage(argv[0]);
+        }
+        ++i;
+    }
+}
+
+static inline void bench_finish(BenchOptions* opt) {
+    if (opt->out != stdout)
+        fclose(opt->out);
+}
+
+/* ====== 每個案例在獨立的子行程中執行 ======
+
+   ru_maxrss 是整個行程到目前為止的峰值，同一個行程連續執行
+   多個案例時只會遞增，之後的案例都只會看到最大案例的峰值。
+   因此每個案例都 fork 出子行程執行：父行程只負責依序等待，
+   不準備輸入也不量測，子行程的峰值只包含該案例本身
+  （加上很小的程式映像）。
+
+   用法：
+     if (!bench_case_begin(opt))
+         return;              父行程：案例已在子行程中完成
+     ... 準備輸入、量測、bench_emit ...
+     bench_case_end(opt);
+   ================================================= */
+
+static int bench_in_child = 0;
+
+/* 回傳 1 表示目前在執行案例的子行程中；無法 fork 時退回在本行程執行 */
+static inline int bench_case_begin(const BenchOptions* opt) {
+    int status;
+    pid_t pid;
+
+    /* 先寫出緩衝區，避免子行程重複輸出 */
+    fflush(opt->out);
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if (pid == 0) {
+        bench_in_child = 1;
+        return 1;
+    }
+    if (pid < 0)
+        return 1;
+
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "benchmark 案例執行失敗\n");
+        exit(1);
+    }
+    return 0;
+}
+
+/* 子行程寫出結果後立即結束，不執行 atexit 與解構 */
+static inline void bench_case_end(const BenchOptions* opt) {
+    if (!bench_in_child)
+        return;
+    fflush(opt->out);
+    fflush(stdout);
+    _exit(0);
+}
+
+/* 輸出一筆結果（一行 JSON） */
+static inline void bench_emit(const BenchOptions* opt, const BenchResult* r) {
+    double perSec = r->seconds > 0 ? r->iterations * r->opsPerIteration / r->seconds : 0;
+    fprintf(opt->out,
+            "{\"benchmark\": \"%s\", \"impl\": \"%s\", \"op\": \"%s\", \"shape\": \"%s\", "
+            "\"size\": %ld, \"iterations\": %ld, \"seconds\": %.6f, \"unit\": \"%s\", "
+            "\"ops_per_sec\": %.3f, \"allocations\": %lld, \"allocations_per_iteration\": %.3f, "
+            "\"peak_rss_kb\": %ld, \"checksum\": %.9g}\n",
+            r->benchmark, r->impl, r->op, r->shape ? r->shape : "", r->size, r->iterations,
+            r->seconds, r->unit, perSec, r->allocations,
+            r->iterations ? (double)r->allocations / r->iterations : 0.0,
+            bench_peak_rss_kb(), r->checksum);
+    fflush(opt->out);
+}
+
+/* ====== 可重現的測試資料 ====== */
+
+static unsigned long long bench_rng_state = 1;
+
+static inline void bench_seed(unsigned long long seed) {
+    bench_rng_state = seed ? seed : 1;
+}
+
+/* xorshift64* */
+static inline unsigned bench_rand(void) {
+    bench_rng_state ^= bench_rng_state >> 12;
+    bench_rng_state ^= bench_rng_state << 25;
+    bench_rng_state ^= bench_rng_state >> 27;
+    return (unsigned)((bench_rng_state * 2685821657736338717ULL) >> 32);
+}
+
+/* 產生 n 項多項式的文字 "n c1 e1 ... cn en"（指數遞減，係數為 -9..9 的非零整數）
+   sparse 為 0 時指數為 n-1..0；否則相鄰指數間隔 1..16
+   回傳的字串需以 free 釋放 */
+static inline char* bench_poly_text(int n, int sparse, unsigned long long seed) {
+    size_t cap = 16 + (size_t)n * 24;
+    char* buf = (char*)malloc(cap);
+    size_t len = (size_t)sprintf(buf, "%d", n);
+    int exp = sparse ? n * 16 : n - 1;
+
+    bench_seed(seed);
+    for (int i = 0; i < n; ++i) {
+        int coef = (int)(bench_rand() % 19) - 9;
+        if (coef == 0)
+            coef = 1;
+        len += (size_t)sprintf(buf + len, " %d %d", coef, exp);
+        exp -= sparse ? 1 + (int)(bench_rand() % 16) : 1;
+    }
+    return buf;
+}
+
+#ifdef __cplusplus
+
+#include <new>
+
+/* 重複執行 f 直到累計至少 minTime 秒，回傳執行次數 */
+template <class F>
+long bench_loop(double minTime, double* seconds, F f) {
+    long iters = 0;
+    double start = bench_now(), now;
+    do {
+        f();
+        ++iters;
+        now = bench_now();
+    } while (now - start < minTime);
+    *seconds = now - start;
+    return iters;
+}
+
+/* 以 operator new 統計 C++ 的配置次數 */
+void* operator new(std::size_t n) {
+    bench_alloc_count++;
+    if (void* p = malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    free(p);
+}
+
+#endif /* __cplusplus */
+
+#endif /* BENCH_UTIL_H */
@@ -0,0 +1,24 @@
+/* =================================================
+   HW2 Problem 1：陣列版 Polynomial benchmark
+   ================================================= */
+
+#include "poly_suite.h"
+
+#define main hw2_main
+#include "../HW2/Problem 1/main.cpp"
+#undef main
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    bench_parse_args(argc, argv, &opt);
+
+    run_poly_suite<Polynomial>(
+        opt, "hw2_array",
+        [](Polynomial& p, istream& in) { p.ReadTerms(in); },
+        [](const Polynomial& a, const Polynomial& b) { return a.Add(b); },
+        [](const Polynomial& a, const Polynomial& b) { return a.Mult(b); },
+        [](const Polynomial& a, float x) { return a.Eval(x); });
+
+    bench_finish(&opt);
+    return 0;
+}
@@ -0,0 +1,32 @@
+/* =================================================
+   HW3 Problem 1：鏈結串列版 Polynomial benchmark
+   同時量測循環鏈結串列（Polynomial）與
+   展開式串列（BlockPolynomial）兩種實作
+   ================================================= */
+
+#include "poly_suite.h"
+
+#define main hw3_main
+#include "../HW3/Problem1/main.cpp"
+#undef main
+
+template <class P>
+void run(const BenchOptions& opt, const char* impl) {
+    run_poly_suite<P>(
+        opt, impl,
+        [](P& p, istream& in) { in >> p; },
+        [](const P& a, const P& b) { return a + b; },
+        [](const P& a, const P& b) { return a * b; },
+        [](const P& a, float x) { return a.Evaluate(x); });
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    bench_parse_args(argc, argv, &opt);
+
+    run<Polynomial>(opt, "hw3_list");
+    run<BlockPolynomial>(opt, "hw3_block");
+
+    bench_finish(&opt);
+    return 0;
+}
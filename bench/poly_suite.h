@@ -0,0 +1,90 @@
+#ifndef POLY_SUITE_H
+#define POLY_SUITE_H
+
+/* =================================================
+   多項式 benchmark 的共同案例
+   HW2 與 HW3 都以相同的種子產生相同的輸入，並輸出相同的
+   (op, shape, size) 組合，checksum（結果在 x = 1 的值）
+   也應一致，方便逐筆比較不同實作。
+   ================================================= */
+
+#include "bench_util.h"
+#include <sstream>
+#include <string>
+
+// 加法與計算的項數；乘法的結果項數成長很快，另外使用較小的規模
+static const int polyLinearSizes[] = {1000, 10000, 100000};
+static const int polyMultSizes[] = {16, 64, 256};
+
+// Load(P&, istream&)、Add(a, b)、Mult(a, b)、Eval(a, x) 包裝各實作的介面
+template <class P, class Load, class Add, class Mult, class Eval>
+void run_poly_suite(const BenchOptions& opt, const char* impl,
+                    Load load, Add add, Mult mult, Eval eval) {
+    static const char* const shapes[] = {"dense", "sparse"};
+
+    for (int sparse = 0; sparse < 2; ++sparse) {
+        for (int op = 0; op < 3; ++op) {
+            const int* sizes = op == 1 ? polyMultSizes : polyLinearSizes;
+            for (int k = 0; k < 3; ++k) {
+                int n = sizes[k] * opt.scale;
+                if (!bench_case_begin(&opt))
+                    continue;
+
+                char* ta = bench_poly_text(n, sparse, 1000 + n);
+                char* tb = bench_poly_text(n, sparse, 2000 + n);
+                P a, b;
+                {
+                    std::istringstream sa(ta), sb(tb);
+                    load(a, sa);
+                    load(b, sb);
+                }
+                free(ta);
+                free(tb);
+
+                BenchResult r = {};
+                r.benchmark = "polynomial";
+                r.impl = impl;
+                r.shape = shapes[sparse];
+                r.unit = "op";
+                r.size = n;
+                r.opsPerIteration = 1;
+
+                // 先計算一次 checksum（結果在 x = 1 的值），同時當作未計時的暖身：
+                // 第一次呼叫的一次性配置（例如 HW3 切割 slab）因此不計入 allocations，
+                // allocations_per_iteration 不會隨機器速度（執行次數）改變
+                long long allocs;
+                volatile float sink = 0;
+                if (op == 0) {
+                    r.op = "add";
+                    r.checksum = eval(add(a, b), 1.0f);
+                    allocs = bench_alloc_count;
+                    r.iterations = bench_loop(opt.minTime, &r.seconds, [&] {
+                        P c = add(a, b);
+                    });
+                }
+                else if (op == 1) {
+                    r.op = "mult";
+                    r.checksum = eval(mult(a, b), 1.0f);
+                    allocs = bench_alloc_count;
+                    r.iterations = bench_loop(opt.minTime, &r.seconds, [&] {
+                        P c = mult(a, b);
+                    });
+                }
+                else {
+                    r.op = "eval";
+                    r.checksum = eval(a, 1.0f);
+                    allocs = bench_alloc_count;
+                    r.iterations = bench_loop(opt.minTime, &r.seconds, [&] {
+                        sink = eval(a, 0.999f);
+                    });
+                }
+                r.allocations = bench_alloc_count - allocs;
+                (void)sink;
+                bench_emit(&opt, &r);
+                bench_case_end(&opt);
+            }
+        }
+    }
+}
+
+#endif /* POLY_SUITE_H */
@@ -0,0 +1,74 @@
+/* =================================================
+   HW1 Problem 2：Power set benchmark
+   量測每秒列舉的子集合數；列舉期間把 stdout 導向
+   /dev/null，只量測遞迴與格式化輸出的成本
+   ================================================= */
+
+#include "bench_util.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+#define main powerset_main
+#include "../HW1/Problem 2/mian.c"
+#undef main
+
+static void run_case(const BenchOptions* opt, int n) {
+    if (!bench_case_begin(opt))
+        return;
+
+    char** elems = (char**)malloc(sizeof(char*) * n);
+    int* pick = (int*)calloc(n, sizeof(int));
+    for (int i = 0; i < n; ++i) {
+        elems[i] = (char*)malloc(16);
+        sprintf(elems[i], "e%d", i);
+    }
+
+    /* 暫時把 stdout 導向 /dev/null */
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+    close(devnull);
+
+    long iters = 0;
+    double start = bench_now(), now;
+    do {
+        powerset_dfs(0, n, elems, pick);
+        ++iters;
+        now = bench_now();
+    } while (now - start < opt->minTime);
+
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+
+    BenchResult r = {0};
+    r.benchmark = "powerset";
+    r.impl = "dfs";
+    r.op = "enumerate";
+    r.unit = "subset";
+    r.size = n;
+    r.iterations = iters;
+    r.opsPerIteration = (double)(1L << n);
+    r.seconds = now - start;
+    r.checksum = (double)(1L << n);
+    bench_emit(opt, &r);
+
+    for (int i = 0; i < n; ++i)
+        free(elems[i]);
+    free(elems);
+    free(pick);
+    bench_case_end(opt);
+}
+
+int main(int argc, char** argv) {
+    static const int sizes[] = {8, 12, 16, 18};
+    BenchOptions opt;
+    bench_parse_args(argc, argv, &opt);
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        run_case(&opt, sizes[i]);
+
+    bench_finish(&opt);
+    return 0;
+}
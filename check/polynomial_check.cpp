@@ -0,0 +1,163 @@
+/* =================================================
+   HW3 Problem 1：多項式實作的交叉檢查
+
+   以隨機產生的輸入比較三種實作的結果：
+     - Polynomial：循環鏈結串列（加減法的合併、乘法的就地合併）
+     - BlockPolynomial：展開式串列（乘法就地合併時的區塊分裂、
+       接到前一個區塊尾端、空區塊立即回收等游標規則）
+     - 以 std::map 撰寫的參考實作
+   輸入也包含任意順序與指數重複的項目，檢查讀入時的排序與合併。
+   任一結果不一致即輸出該組輸入並以狀態 1 結束；
+   所有多項式解構後，也確認節點、區塊與共用串列都已回收。
+
+   用法：check_polynomial [案例數]（預設 3000）
+   以 -fsanitize=address,undefined 編譯可一併檢查記憶體錯誤。
+   ================================================= */
+
+#include <map>
+#include <random>
+#include <sstream>
+
+#define main hw3_main
+#include "../HW3/Problem1/main.cpp"
+#undef main
+
+// 參考實作：指數 -> 係數，依指數遞減排列，不存放係數為 0 的項
+typedef map<int, int, greater<int>> RefPoly;
+
+RefPoly RefAdd(const RefPoly& a, const RefPoly& b, int sign) {
+    RefPoly c = a;
+    for (auto& t : b) {
+        if ((c[t.first] += sign * t.second) == 0)
+            c.erase(t.first);
+    }
+    return c;
+}
+
+RefPoly RefMult(const RefPoly& a, const RefPoly& b) {
+    RefPoly c;
+    for (auto& ta : a) {
+        for (auto& tb : b) {
+            int e = ta.first + tb.first;
+            if ((c[e] += ta.second * tb.second) == 0)
+                c.erase(e);
+        }
+    }
+    return c;
+}
+
+// 與 HW3 的 operator<< 相同的格式
+ostream& operator<<(ostream& os, const RefPoly& x) {
+    bool first = true;
+    for (auto& t : x) {
+        if (!first && t.second > 0)
+            os << "+";
+        os << t.second << "x^" << t.first;
+        first = false;
+    }
+    return os;
+}
+
+// 三種實作共用的運算式，結果以 | 分隔輸出
+// mult(a, b) 與 add(a, b, sign) 包裝各實作的介面
+template <class P, class Add, class Mult>
+string Exercise(const P& a, const P& b, Add add, Mult mult) {
+    ostringstream os;
+    P ab = mult(a, b);
+    P c = a;             // 複製後再指派，確認共用 / 複製的串列不受影響
+    c = mult(c, b);
+    os << add(a, b, 1) << "|" << add(a, b, -1) << "|" << add(b, a, -1) << "|"
+       << ab << "|" << add(ab, mult(b, a), -1) << "|" << mult(ab, a) << "|"
+       << mult(add(a, b, 1), add(a, b, -1)) << "|" << c << "|" << a << "|" << b;
+    return os.str();
+}
+
+// n 項、係數非 0 的多項式，格式為 n c1 e1 ... cn en
+// span 越小越稠密，乘積中相同指數的項目越多。
+// 奇數案例的項目以任意順序輸出，並把部分係數拆成兩個指數相同的項
+// （可能出現係數為 0 的項），檢查輸入時的排序與合併。
+string Generate(mt19937& rng, int n, int span, bool shuffled, RefPoly& ref) {
+    vector<pair<int, int>> items; // (係數, 指數)
+    for (int e = span + n; e >= 0 && (int)ref.size() < n; e--) {
+        if (rng() % 2 == 0)
+            continue;
+        int c = (int)(rng() % 7) - 3;
+        if (c == 0)
+            c = 1;
+        ref[e] = c;
+        if (shuffled && rng() % 4 == 0) {
+            int d = (int)(rng() % 7) - 3;
+            items.push_back({d, e});
+            items.push_back({c - d, e});
+        }
+        else {
+            items.push_back({c, e});
+        }
+    }
+    if (shuffled)
+        shuffle(items.begin(), items.end(), rng);
+
+    ostringstream os;
+    os << items.size();
+    for (auto& t : items)
+        os << " " << t.first << " " << t.second;
+    return os.str();
+}
+
+int main(int argc, char* argv[]) {
+    int cases = argc > 1 ? atoi(argv[1]) : 3000;
+    mt19937 rng(20240101);
+    int failures = 0;
+
+    for (int k = 0; k < cases && failures < 3; k++) {
+        // 大部分案例在一個區塊左右，每 10 個案例放大一次以產生多個區塊
+        int limit = k % 10 == 0 ? 120 : 40;
+        int na = rng() % limit, nb = rng() % limit;
+        int span = 1 + rng() % (k % 2 ? 8 : 200);
+
+        RefPoly ra, rb;
+        string ta = Generate(rng, na, span, k % 2, ra);
+        string tb = Generate(rng, nb, span, k % 2, rb);
+
+        string expected = Exercise(ra, rb,
+            [](const RefPoly& a, const RefPoly& b, int sign) { return RefAdd(a, b, sign); },
+            RefMult);
+
+        Polynomial pa, pb;
+        BlockPolynomial ba, bb;
+        istringstream(ta) >> pa;
+        istringstream(tb) >> pb;
+        istringstream(ta) >> ba;
+        istringstream(tb) >> bb;
+
+        string list = Exercise(pa, pb,
+            [](const Polynomial& a, const Polynomial& b, int sign) { return sign > 0 ? a + b : a - b; },
+            [](const Polynomial& a, const Polynomial& b) { return a * b; });
+        string block = Exercise(ba, bb,
+            [](const BlockPolynomial& a, const BlockPolynomial& b, int sign) { return sign > 0 ? a + b : a - b; },
+            [](const BlockPolynomial& a, const BlockPolynomial& b) { return a * b; });
+
+        if (list != expected || block != expected) {
+            failures++;
+            cerr << "案例 " << k << " 結果不一致\n"
+                 << "  a = " << ta << "\n  b = " << tb << "\n"
+                 << "  參考實作        " << expected << "\n"
+                 << "  Polynomial      " << list << "\n"
+                 << "  BlockPolynomial " << block << "\n";
+        }
+    }
+
+    // 所有多項式都已解構，不應有仍在使用中的節點
+    long nodes = AvailableList::LiveNodes();
+    long blocks = AvailableBlockList::LiveNodes();
+    long reps = AvailableRepList::LiveNodes();
+    if (nodes || blocks || reps) {
+        failures++;
+        cerr << "未回收：節點 " << nodes << "、區塊 " << blocks << "、共用串列 " << reps << "\n";
+    }
+
+    if (failures)
+        return 1;
+    cout << cases << " 個案例全部一致" << endl;
+    return 0;
+}
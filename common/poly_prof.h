@@ -0,0 +1,235 @@
+#ifndef POLY_PROF_H
+#define POLY_PROF_H
+
+/* =================================================
+   多項式效能量測（HW2 / HW3 共用）
+
+   編譯時加上 -DPOLY_PROFILE 才會啟用；未啟用時下列巨集
+   全部展開為空敘述，不產生任何額外的程式碼或資料。
+
+   POLY_PROF_COUNT(c, n)        計數器 c 加 n
+   POLY_PROF_POOL(pool, c, n)   可用空間串列 pool 的計數器 c 加 n
+                                （Get / Return 同時更新存活數與峰值）
+   POLY_PROF_SCOPE(op)          量測目前區塊的執行時間並記錄到 op
+   POLY_PROF_DUMP(os)           立即把統計資料以 JSON 輸出到 os
+
+   程式結束時會自動輸出一次：若設定環境變數 POLY_PROF_OUT
+   則寫入該檔案，否則輸出到 stderr。
+   ================================================= */
+
+namespace polyprof {
+
+// 可用空間串列的種類（未啟用時也保留，供樣板參數使用）
+enum Pool {
+    PoolNodes,      // HW3 PolyNode
+    PoolBlocks,     // HW3 TermBlock
+    PoolReps,       // HW3 PolyRep（共用的項目串列）
+    PoolCount
+};
+
+} // namespace polyprof
+
+#ifdef POLY_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace polyprof {
+
+// 計數器
+enum Counter {
+    ArrayAlloc,     // 配置的 Term 陣列數
+    ArrayRealloc,   // 因容量不足重新配置的 Term 陣列數
+    CounterCount
+};
+
+// 每個可用空間串列各自的計數器
+enum PoolCounter {
+    Get,            // 取得次數
+    Fresh,          // 交出的是新配置（而非回收）的次數
+    Return,         // 回收次數
+    SlabAlloc,      // 配置的 slab 數
+    SlabRelease,    // Trim 釋放的 slab 數
+    PoolCounterCount
+};
+
+// 量測執行時間的運算
+enum Op {
+    OpAdd,          // HW2 Add
+    OpMult,         // HW2 Mult
+    OpEval,         // HW2 Eval
+    OpPlus,         // HW3 operator+
+    OpMinus,        // HW3 operator-
+    OpTimes,        // HW3 operator*
+    OpEvaluate,     // HW3 Evaluate
+    OpCount
+};
+
+static const char* const counterNames[CounterCount] = {
+    "array_alloc", "array_realloc"
+};
+
+static const char* const poolNames[PoolCount] = {
+    "nodes", "blocks", "reps"
+};
+
+static const char* const poolCounterNames[PoolCounterCount] = {
+    "get", "fresh", "return", "slab_alloc", "slab_release"
+};
+
+static const char* const opNames[OpCount] = {
+    "Add", "Mult", "Eval", "operator+", "operator-", "operator*", "Evaluate"
+};
+
+// 直方圖第 i 格記錄 [2^i, 2^(i+1)) 奈秒的呼叫次數
+static const int Buckets = 40;
+
+struct OpStat {
+    std::atomic<long long> calls;
+    std::atomic<long long> totalNs;
+    std::atomic<long long> maxNs;
+    std::atomic<long long> hist[Buckets];
+};
+
+// 靜態儲存期的 atomic 會被初始化為 0
+inline std::atomic<long long> counters[CounterCount];
+inline std::atomic<long long> poolCounters[PoolCount][PoolCounterCount];
+inline std::atomic<long long> live[PoolCount];      // 目前交出未回收的數量
+inline std::atomic<long long> peakLive[PoolCount];
+inline OpStat ops[OpCount];
+
+inline void UpdateMax(std::atomic<long long>& m, long long v) {
+    long long cur = m.load(std::memory_order_relaxed);
+    while (v > cur && !m.compare_exchange_weak(cur, v, std::memory_order_relaxed))
+        ;
+}
+
+inline void Count(Counter c, long long n) {
+    counters[c].fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void CountPool(int p, PoolCounter c, long long n) {
+    poolCounters[p][c].fetch_add(n, std::memory_order_relaxed);
+    if (c == Get)
+        UpdateMax(peakLive[p], live[p].fetch_add(n, std::memory_order_relaxed) + n);
+    else if (c == Return)
+        live[p].fetch_sub(n, std::memory_order_relaxed);
+}
+
+inline void Record(Op op, long long ns) {
+    OpStat& s = ops[op];
+    s.calls.fetch_add(1, std::memory_order_relaxed);
+    s.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    UpdateMax(s.maxNs, ns);
+    int b = 0;
+    while (b + 1 < Buckets && (ns >> (b + 1)) > 0)
+        b++;
+    s.hist[b].fetch_add(1, std::memory_order_relaxed);
+}
+
+// 建構時開始計時，解構時記錄
+class Timer {
+public:
+    explicit Timer(Op o) : op(o), start(std::chrono::steady_clock::now()) {}
+    ~Timer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        Record(op, ns);
+    }
+
+private:
+    Op op;
+    std::chrono::steady_clock::time_point start;
+};
+
+inline void Dump(std::ostream& os) {
+    os << "{\n  \"counters\": {";
+    for (int i = 0; i < CounterCount; i++) {
+        os << (i ? ",\n" : "\n") << "    \"" << counterNames[i] << "\": "
+           << counters[i].load(std::memory_order_relaxed);
+    }
+    os << "\n  },\n";
+
+    // 只輸出有使用過的可用空間串列
+    os << "  \"pools\": {";
+    bool firstPool = true;
+    for (int p = 0; p < PoolCount; p++) {
+        long long get = poolCounters[p][Get].load(std::memory_order_relaxed);
+        if (get == 0)
+            continue;
+        long long fresh = poolCounters[p][Fresh].load(std::memory_order_relaxed);
+        os << (firstPool ? "\n" : ",\n") << "    \"" << poolNames[p] << "\": {";
+        for (int i = 0; i < PoolCounterCount; i++) {
+            os << (i ? ", " : "") << "\"" << poolCounterNames[i] << "\": "
+               << poolCounters[p][i].load(std::memory_order_relaxed);
+        }
+        // 沒有取自新配置記憶體的取得，都是回收再利用
+        os << ", \"hit_rate\": " << double(get - fresh) / get
+           << ", \"live\": " << live[p].load(std::memory_order_relaxed)
+           << ", \"peak_live\": " << peakLive[p].load(std::memory_order_relaxed) << "}";
+        firstPool = false;
+    }
+    os << "\n  },\n";
+    os << "  \"ops\": {";
+
+    bool firstOp = true;
+    for (int i = 0; i < OpCount; i++) {
+        long long calls = ops[i].calls.load(std::memory_order_relaxed);
+        if (calls == 0)
+            continue;
+        long long total = ops[i].totalNs.load(std::memory_order_relaxed);
+        os << (firstOp ? "\n" : ",\n") << "    \"" << opNames[i] << "\": {"
+           << "\"calls\": " << calls
+           << ", \"total_ns\": " << total
+           << ", \"mean_ns\": " << total / calls
+           << ", \"max_ns\": " << ops[i].maxNs.load(std::memory_order_relaxed)
+           << ", \"histogram_ns\": [";
+        bool firstBucket = true;
+        for (int b = 0; b < Buckets; b++) {
+            long long n = ops[i].hist[b].load(std::memory_order_relaxed);
+            if (n == 0)
+                continue;
+            os << (firstBucket ? "" : ", ") << "{\"ge\": " << (b ? 1LL << b : 0)
+               << ", \"lt\": " << (1LL << (b + 1)) << ", \"count\": " << n << "}";
+            firstBucket = false;
+        }
+        os << "]}";
+        firstOp = false;
+    }
+    os << "\n  }\n}\n";
+}
+
+inline void DumpAtExit() {
+    const char* path = std::getenv("POLY_PROF_OUT");
+    if (path && *path) {
+        std::ofstream out(path);
+        Dump(out);
+    }
+    else {
+        Dump(std::cerr);
+    }
+}
+
+// inline 變數在整個程式中只有一份，多個編譯單元引入本檔時也只註冊一次
+inline const bool dumpRegistered = (std::atexit(DumpAtExit), true);
+
+} // namespace polyprof
+
+#define POLY_PROF_COUNT(c, n)       polyprof::Count(polyprof::c, (n))
+#define POLY_PROF_POOL(pool, c, n)  polyprof::CountPool((pool), polyprof::c, (n))
+#define POLY_PROF_SCOPE(op)         polyprof::Timer polyProfTimer(polyprof::op)
+#define POLY_PROF_DUMP(os)          polyprof::Dump(os)
+
+#else
+
+#define POLY_PROF_COUNT(c, n)       ((void)0)
+#define POLY_PROF_POOL(pool, c, n)  ((void)0)
+#define POLY_PROF_SCOPE(op)         ((void)0)
+#define POLY_PROF_DUMP(os)          ((void)0)
+
+#endif // POLY_PROFILE
+
+#endif // POLY_PROF_H
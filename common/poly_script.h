@@ -0,0 +1,127 @@
+#ifndef POLY_SCRIPT_H
+#define POLY_SCRIPT_H
+
+/* =================================================
+   多項式批次指令模式（HW2 / HW3 共用）
+
+   從指令檔逐行讀取指令，結果存放在具名暫存器中，
+   同一個行程內可以重複使用，不必每次重新輸入：
+     load  r n c1 e1 ... cn en   讀入多項式到暫存器 r
+                                 （項目可任意順序，相同指數會合併）
+     add   d a b                 d = a + b
+     sub   d a b                 d = a - b
+     mul   d a b                 d = a * b
+     store d a                   d = a
+     eval  a x                   輸出 a 在 x 的值
+     print a                     輸出 a
+   空白行與 # 開頭的行會被略過；每一行的執行時間輸出到 stderr。
+   指令格式不符、項數為負或暫存器不存在時，輸出錯誤並回傳 1。
+
+   範例：
+     load p1 4 5 5 -3 3 2 1 -7 0
+     load p2 4 -5 5 3 4 -2 1 4 0
+     mul m p1 p2
+     sub d m p1
+     print d
+     eval m 2
+
+   各程式以 lambda 包裝自己的介面：
+     load(P&, istream&)      讀入 n c1 e1 ... cn en，失敗時回傳 false
+     add / sub / mult(a, b)  回傳新的多項式
+     eval(a, x)              回傳 a 在 x 的值
+   輸出使用 P 的 operator<<。
+   ================================================= */
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+template <class P, class Load, class Add, class Sub, class Mult, class Eval>
+int RunPolyScript(std::istream& in, Load load, Add add, Sub sub, Mult mult, Eval eval) {
+    std::map<std::string, P> reg;
+    std::string line;
+    int lineNo = 0;
+    double totalMs = 0;
+
+    // 取得已存在的暫存器，不存在時回傳 nullptr
+    auto find = [&reg](const std::string& name) -> const P* {
+        auto it = reg.find(name);
+        return it == reg.end() ? nullptr : &it->second;
+    };
+
+    while (std::getline(in, line)) {
+        lineNo++;
+        std::istringstream ls(line);
+        std::string cmd;
+        if (!(ls >> cmd) || cmd[0] == '#')
+            continue;
+
+        auto start = std::chrono::steady_clock::now();
+        std::string d, a, b;
+        bool ok = true;
+
+        if (cmd == "load") {
+            ok = static_cast<bool>(ls >> d) && load(reg[d], ls);
+        }
+        else if (cmd == "add" || cmd == "sub" || cmd == "mul") {
+            ok = static_cast<bool>(ls >> d >> a >> b);
+            const P *pa = find(a), *pb = find(b);
+            if (ok && pa && pb) {
+                if (cmd == "add")
+                    reg[d] = add(*pa, *pb);
+                else if (cmd == "sub")
+                    reg[d] = sub(*pa, *pb);
+                else
+                    reg[d] = mult(*pa, *pb);
+            }
+            else {
+                ok = false;
+            }
+        }
+        else if (cmd == "store") {
+            ok = static_cast<bool>(ls >> d >> a);
+            const P* pa = find(a);
+            if (ok && pa)
+                reg[d] = *pa;
+            else
+                ok = false;
+        }
+        else if (cmd == "eval") {
+            float x;
+            ok = static_cast<bool>(ls >> a >> x);
+            const P* pa = find(a);
+            if (ok && pa)
+                std::cout << a << "(" << x << ") = " << eval(*pa, x) << std::endl;
+            else
+                ok = false;
+        }
+        else if (cmd == "print") {
+            ok = static_cast<bool>(ls >> a);
+            const P* pa = find(a);
+            if (ok && pa)
+                std::cout << a << " = " << *pa << std::endl;
+            else
+                ok = false;
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "第 " << lineNo << " 行錯誤（指令格式不符或暫存器不存在）：" << line << std::endl;
+            return 1;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        totalMs += ms;
+        std::cerr << "[第 " << lineNo << " 行] " << cmd << " " << ms << " ms" << std::endl;
+    }
+
+    std::cerr << "總計 " << totalMs << " ms" << std::endl;
+    return 0;
+}
+
+#endif // POLY_SCRIPT_H